@@ -1,9 +1,12 @@
 // Local headers
 #include "CommandParser.h"
 #include "../core/Indexer.h"
+#include "../core/KeywordMatcher.h"
+#include "../core/ContentClassifier.h"
 
 // Standard library headers
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -11,6 +14,7 @@
 #include <set>
 #include <algorithm>
 #include <cstdlib>
+#include <cstdio>
 #include <iomanip>
 #include <cctype>
 
@@ -18,20 +22,83 @@
 #include <thread>
 #include <mutex>
 #include <future>
+#include <atomic>
 
 namespace wyaFile {
 
+namespace {
+
+// Case-insensitive substring search without copying the haystack
+bool containsIgnoreCase(const std::string& content, const std::string& lower_keyword) {
+    auto it = std::search(content.begin(), content.end(), lower_keyword.begin(), lower_keyword.end(),
+        [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == b;
+        });
+    return it != content.end();
+}
+
+// Escapes a string for use inside a JSON string literal. Bytes that are not valid
+// UTF-8 (Linux paths may contain any byte) become U+FFFD so every line stays valid JSON.
+std::string jsonEscape(const std::string& text) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    std::string escaped;
+    escaped.reserve(text.size() + 2);
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (bytes[i] < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", bytes[i]);
+                    escaped += buffer;
+                } else if (bytes[i] < 0x80) {
+                    escaped += c;
+                } else {
+                    int length = ContentClassifier::utf8SequenceLength(bytes, i, text.size());
+                    if (length > 0) {
+                        escaped.append(text, i, static_cast<size_t>(length));
+                        i += static_cast<size_t>(length) - 1;
+                    } else {
+                        escaped += "\\ufffd";
+                    }
+                }
+        }
+    }
+    return escaped;
+}
+
+// Strips leading and trailing whitespace
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+} // namespace
+
 CommandParser::CommandParser() {
     initializeCommands();
 }
 
 void CommandParser::initializeCommands() {
     // Initialize command descriptions
-    command_descriptions["scan"] = "Scan operations: use -key <keyword> for keyword search or -dir <path> for directory scan (requires --allow flag)";
+    command_descriptions["scan"] = "Scan operations: use -key <keyword> for keyword search or -dir <path> for directory scan (requires --allow flag). "
+                                   "Keyword search accepts --max-results <n>, --first and -l to stream matches and stop early";
+    command_descriptions["batch"] = "Run many keyword queries over a single crawl: reads one query per line from stdin or -file <path> "
+                                    "and prints one JSON line per query (requires --allow flag)";
     command_descriptions["help"] = "Show available commands and their descriptions";
 
     // ARG COMMANDS
     arg_commands["scan"] = &CommandParser::handleCommandWithArgs;
+    arg_commands["batch"] = &CommandParser::handleBatchCommand;
 
     // NO ARG COMMANDS
     no_arg_commands["help"] = &CommandParser::handleHelpCommand;
@@ -63,7 +130,7 @@ std::string CommandParser::getFlagValue(const std::string& flag, const std::vect
         if (args[i] == flag && i + 1 < args.size()) {
             // Check if the next argument is not another flag
             std::string next_arg = args[i + 1];
-            if (next_arg[0] != '-' && next_arg[0] != '/') {
+            if (next_arg[0] != '-') {
                 return next_arg;
             }
         }
@@ -154,7 +221,7 @@ std::string CommandParser::handleScanCommand(const std::string& directory_path)
     return result.str();
 }
 
-std::string CommandParser::handleKeyCommand(const std::string& keyword) {    
+CachedSearch CommandParser::searchCorpus(const std::string& keyword) {
     // Scan multiple directories for files
     Indexer indexer;
     std::vector<std::future<DirectoryResult> > futures;
@@ -185,25 +252,12 @@ std::string CommandParser::handleKeyCommand(const std::string& keyword) {
         }
     }
     
+    CachedSearch search;
+    search.scanned_directories = scanned_directories_threaded;
     if (all_file_contents_threaded.empty()) {
-        return "No files found in any of the search directories.";
-    }
-    
-    std::stringstream result;
-    result << "\n";
-    result << "Keyword Search Results\n";
-    result << std::string(50, '=') << "\n\n";
-    result << "Searching for: \"" << keyword << "\"\n";
-    result << "Directories: ";
-    
-    // List all scanned directories
-    for (size_t i = 0; i < scanned_directories_threaded.size(); ++i) {
-        if (i > 0) result << ", ";
-        result << scanned_directories_threaded[i];
+        return search;
     }
-    result << "\n\n";
     
-    std::vector<std::string> matching_files;
     std::set<std::string> seen_filenames;
     std::set<std::string> seen_contents;
     std::mutex search_mtx;
@@ -271,11 +325,72 @@ std::string CommandParser::handleKeyCommand(const std::string& keyword) {
                 // Add to deduplication sets
                 seen_filenames.insert(filename);
                 seen_contents.insert(content);
-                matching_files.push_back(filepath);
+                search.matching_files.push_back(filepath);
             }
         }
     }
     
+    return search;
+}
+
+CachedSearch CommandParser::searchCorpusCached(const std::string& keyword, const std::string& cache_path) {
+    // Stat-only fingerprint of the corpus decides whether cached results are still valid
+    std::vector<std::future<uint64_t> > fingerprint_futures;
+    for (const auto& directory : directories_to_scan) {
+        fingerprint_futures.push_back(std::async(std::launch::async, [directory]() {
+            Indexer indexer;
+            return indexer.fingerprintDirectory(directory);
+        }));
+    }
+    uint64_t corpus_fingerprint = 0;
+    for (auto& future : fingerprint_futures) {
+        corpus_fingerprint = corpus_fingerprint * 0x100000001b3ULL + future.get();
+    }
+
+    ResultCache result_cache;
+    result_cache.load(cache_path);
+    result_cache.observeCorpus(corpus_fingerprint);
+
+    // Serve repeated queries on an unchanged corpus without crawling
+    std::string cache_key = ResultCache::makeKey(keyword, directories_to_scan);
+    CachedSearch search;
+    if (!result_cache.get(cache_key, search)) {
+        search = searchCorpus(keyword);
+        result_cache.put(cache_key, search);
+    }
+
+    // A hit may have moved its entry to the front; persist that so eviction stays LRU
+    if (result_cache.isModified()) {
+        result_cache.save(cache_path);
+    }
+    return search;
+}
+
+std::string CommandParser::handleKeyCommand(const std::string& keyword, bool use_disk_cache) {
+    // Only --cache pays for the fingerprint walk; the default path crawls directly
+    std::string cache_path = use_disk_cache ? ResultCache::defaultPath() : "";
+    CachedSearch search = cache_path.empty() ? searchCorpus(keyword) : searchCorpusCached(keyword, cache_path);
+
+    const auto& scanned_directories = search.scanned_directories;
+    const auto& matching_files = search.matching_files;
+    if (scanned_directories.empty()) {
+        return "No files found in any of the search directories.";
+    }
+    
+    std::stringstream result;
+    result << "\n";
+    result << "Keyword Search Results\n";
+    result << std::string(50, '=') << "\n\n";
+    result << "Searching for: \"" << keyword << "\"\n";
+    result << "Directories: ";
+    
+    // List all scanned directories
+    for (size_t i = 0; i < scanned_directories.size(); ++i) {
+        if (i > 0) result << ", ";
+        result << scanned_directories[i];
+    }
+    result << "\n\n";
+    
     if (matching_files.empty()) {
         result << "No files found containing \"" << keyword << "\"\n\n";
     } else {
@@ -296,6 +411,239 @@ std::string CommandParser::handleKeyCommand(const std::string& keyword) {
     return result.str();
 }
 
+std::string CommandParser::handleStreamingKeyCommand(const std::string& keyword, size_t max_results, bool list_only) {
+    // Latency-first variant of handleKeyCommand: each match is printed as soon as it is
+    // confirmed, and traversal stops once max_results (0 = unlimited) have been printed.
+    // Matches come in traversal order, so a limit keeps the first found, not the first sorted.
+    std::string lower_keyword = keyword;
+    std::transform(lower_keyword.begin(), lower_keyword.end(), lower_keyword.begin(), ::tolower);
+
+    std::atomic<bool> stop_requested(false);
+    std::mutex output_mtx;
+    std::set<std::string> seen_filenames;
+    std::set<std::string> seen_contents;
+    std::set<std::string> seen_paths;
+    size_t match_count = 0;
+
+    if (!list_only) {
+        std::cout << "\n";
+        std::cout << "Keyword Search Results\n";
+        std::cout << std::string(50, '=') << "\n\n";
+        std::cout << "Searching for: \"" << keyword << "\"\n\n" << std::flush;
+    }
+
+    auto on_file = [&](const std::string& filepath, const std::string& content) -> bool {
+        if (stop_requested.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (!containsIgnoreCase(content, lower_keyword)) {
+            return true;
+        }
+
+        std::string filename = filepath.substr(filepath.find_last_of("/\\") + 1);
+
+        std::lock_guard<std::mutex> lock(output_mtx);
+        if (stop_requested.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        if (list_only) {
+            // Path listings name every matching file, like grep -l; only skip a path
+            // reached twice through overlapping roots
+            if (!seen_paths.insert(filepath).second) {
+                return true;
+            }
+        } else {
+            // Skip if we've already seen this filename or content
+            if (seen_filenames.find(filename) != seen_filenames.end() ||
+                seen_contents.find(content) != seen_contents.end()) {
+                return true;
+            }
+            seen_filenames.insert(filename);
+            seen_contents.insert(content);
+        }
+        match_count++;
+
+        if (list_only) {
+            std::cout << filepath << "\n";
+        } else {
+            std::cout << "  " << match_count << ". \033[32m" << filename << "\033[0m\n";
+            std::cout << "      Path: " << filepath << "\n";
+        }
+        std::cout << std::flush;
+
+        if (max_results > 0 && match_count >= max_results) {
+            stop_requested.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    };
+
+    // Parallelize the traversal of directories; each thread searches files as it reads them
+    std::vector<std::future<void> > futures;
+    for (const auto& directory : directories_to_scan) {
+        futures.push_back(std::async(std::launch::async, [directory, &on_file, &stop_requested]() {
+            Indexer indexer;
+            indexer.visitDirectory(directory, on_file, &stop_requested);
+        }));
+    }
+
+    // Block until Threads have Finished or bailed out
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    if (list_only) {
+        return "";
+    }
+
+    std::stringstream result;
+    if (match_count == 0) {
+        result << "No files found containing \"" << keyword << "\"\n\n";
+    } else {
+        result << "\n";
+    }
+    if (stop_requested.load()) {
+        result << "Search stopped after " << match_count << " result(s)\n";
+    } else {
+        result << "Search complete\n";
+    }
+
+    return result.str();
+}
+
+std::string CommandParser::handleBatchCommand(const CommandArgs& args) {
+    if (!hasFlag("--allow")) {
+        return "ERROR: Directory access requires --allow flag.\n"
+               "Usage: batch [-file <path>] --allow";
+    }
+
+    std::vector<std::string> queries;
+    auto read_queries = [&queries](std::istream& in) {
+        std::string line;
+        while (std::getline(in, line)) {
+            std::string query = trim(line);
+            // Skip blank lines and comments
+            if (!query.empty() && query[0] != '#') {
+                queries.push_back(query);
+            }
+        }
+    };
+
+    if (hasFlag("-file")) {
+        std::string query_file = getFlagValue("-file", args);
+        if (query_file.empty()) {
+            return "ERROR: Missing path after -file flag.\n"
+                   "Usage: batch -file <path> --allow";
+        }
+        std::ifstream file(query_file);
+        if (!file.is_open()) {
+            return "ERROR: Could not open query file: " + query_file;
+        }
+        read_queries(file);
+    } else {
+        read_queries(std::cin);
+    }
+
+    if (queries.empty()) {
+        return "ERROR: No queries given.\n"
+               "Usage: batch [-file <path>] --allow (one keyword per line)";
+    }
+
+    runBatchQueries(queries, std::cout);
+    return "";
+}
+
+void CommandParser::runBatchQueries(const std::vector<std::string>& queries, std::ostream& out) {
+    // Normalize queries and collapse duplicates so each is matched once
+    std::vector<std::string> unique_keywords;
+    std::map<std::string, size_t> keyword_ids;
+    std::vector<size_t> query_keyword(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::string lower_query = queries[i];
+        std::transform(lower_query.begin(), lower_query.end(), lower_query.begin(), ::tolower);
+
+        auto inserted = keyword_ids.emplace(lower_query, unique_keywords.size());
+        if (inserted.second) {
+            unique_keywords.push_back(lower_query);
+        }
+        query_keyword[i] = inserted.first->second;
+    }
+
+    KeywordMatcher matcher(unique_keywords);
+
+    // Per keyword: (filepath, content id) of every matching file
+    std::vector<std::vector<std::pair<std::string, size_t> > > keyword_matches(unique_keywords.size());
+    // Content identity is (FNV-1a hash, size), so matched files are not copied and kept
+    std::map<std::pair<uint64_t, size_t>, size_t> content_ids;
+    std::mutex match_mtx;
+
+    auto on_file = [&](const std::string& filepath, const std::string& content,
+                       KeywordMatcher::Scratch& scratch) -> bool {
+        std::vector<size_t> found = matcher.findMatches(content, scratch);
+        if (found.empty()) {
+            return true;
+        }
+
+        std::pair<uint64_t, size_t> content_key(Indexer::hashBytes(content, 0), content.size());
+
+        std::lock_guard<std::mutex> lock(match_mtx);
+        size_t content_id = content_ids.emplace(content_key, content_ids.size()).first->second;
+        for (size_t keyword_id : found) {
+            keyword_matches[keyword_id].emplace_back(filepath, content_id);
+        }
+        return true;
+    };
+
+    // Crawl every directory once, in parallel, matching all queries per file
+    std::vector<std::future<void> > futures;
+    for (const auto& directory : directories_to_scan) {
+        futures.push_back(std::async(std::launch::async, [directory, &on_file]() {
+            Indexer indexer;
+            KeywordMatcher::Scratch scratch; // reused for every file this thread visits
+            indexer.visitDirectory(directory, [&on_file, &scratch](const std::string& filepath, const std::string& content) {
+                return on_file(filepath, content, scratch);
+            });
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    // Deduplicate each keyword's matches the same way handleKeyCommand does, in path order
+    std::vector<std::vector<std::string> > keyword_results(unique_keywords.size());
+    for (size_t keyword_id = 0; keyword_id < unique_keywords.size(); ++keyword_id) {
+        auto& matches = keyword_matches[keyword_id];
+        std::sort(matches.begin(), matches.end());
+
+        std::set<std::string> seen_filenames;
+        std::set<size_t> seen_contents;
+        for (const auto& [filepath, content_id] : matches) {
+            std::string filename = filepath.substr(filepath.find_last_of("/\\") + 1);
+            // Skip if we've already seen this filename or content; record neither otherwise
+            if (seen_filenames.find(filename) == seen_filenames.end() &&
+                seen_contents.find(content_id) == seen_contents.end()) {
+                seen_filenames.insert(filename);
+                seen_contents.insert(content_id);
+                keyword_results[keyword_id].push_back(filepath);
+            }
+        }
+    }
+
+    // One JSON line per query, in input order
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto& matching_files = keyword_results[query_keyword[i]];
+        out << "{\"query\":\"" << jsonEscape(queries[i]) << "\",\"count\":" << matching_files.size()
+            << ",\"matches\":[";
+        for (size_t j = 0; j < matching_files.size(); ++j) {
+            if (j > 0) out << ",";
+            out << "\"" << jsonEscape(matching_files[j]) << "\"";
+        }
+        out << "]}\n";
+    }
+    out << std::flush;
+}
+
 std::string CommandParser::handleHelpCommand() {
     std::stringstream help;
     help << "\n=== wyaFile Command Help ===\n";
@@ -311,7 +659,13 @@ std::string CommandParser::handleHelpCommand() {
     
     help << "Examples:\n";
     help << "  scan -key <keyword> --allow       - Search examples directory for keyword\n";
+    help << "  scan -key <keyword> --first --allow - Stop at the first matching file found\n";
+    help << "  scan -key <keyword> --max-results <n> --allow - Stream the first n matches found\n";
+    help << "                                      (traversal order, not sorted path order)\n";
+    help << "  scan -key <keyword> -l --allow    - List every matching path, without filename/content dedup\n";
+    help << "  scan -key <keyword> --cache --allow - Reuse results persisted from earlier runs\n";
     help << "  scan -dir /path/to/directory --allow - Scan directory for .txt files\n";
+    help << "  batch -file queries.txt --allow   - Run one query per line, print JSON lines\n";
     help << "===========================\n";
     
     return help.str();
@@ -388,7 +742,27 @@ std::string CommandParser::handleCommandWithArgs(const std::vector<std::string>&
                 return "ERROR: Missing keyword after -key flag.\n"
                        "Usage: scan -key <keyword> --allow";
             }
-            return handleKeyCommand(keyword);
+
+            // Latency-first modes stream matches and stop early
+            size_t max_results = 0;
+            if (hasFlag("--max-results")) {
+                std::string limit = getFlagValue("--max-results", args);
+                if (limit.empty() || limit.size() > 9 || !std::all_of(limit.begin(), limit.end(), ::isdigit) ||
+                    std::stoul(limit) == 0) {
+                    return "ERROR: --max-results requires a positive number.\n"
+                           "Usage: scan -key <keyword> --max-results <n> --allow";
+                }
+                max_results = std::stoul(limit);
+            }
+            if (hasFlag("--first")) {
+                max_results = 1;
+            }
+
+            bool list_only = hasFlag("-l");
+            if (max_results > 0 || list_only) {
+                return handleStreamingKeyCommand(keyword, max_results, list_only);
+            }
+            return handleKeyCommand(keyword, hasFlag("--cache"));
         }
         
         if (has_dir_flag) {
@@ -2,11 +2,13 @@
 #define WYAFILE_COMMANDPARSER_H
 
 #include "../common/Types.h"
+#include "../core/ResultCache.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <set>
 #include <mutex>
+#include <ostream>
 
 namespace wyaFile {
 
@@ -20,7 +22,9 @@ public:
     
     // Individual command handlers
     std::string handleScanCommand(const std::string& directory_path);
-    std::string handleKeyCommand(const std::string& keyword);
+    std::string handleKeyCommand(const std::string& keyword, bool use_disk_cache = false);
+    std::string handleStreamingKeyCommand(const std::string& keyword, size_t max_results, bool list_only);
+    std::string handleBatchCommand(const CommandArgs& args);
     std::string handleHelpCommand();
     std::string handleUnknownCommand(const std::string& command);
     
@@ -49,6 +53,13 @@ public:
     
     // Helper methods for function pointers
     std::string handleCommandWithArgs(const CommandArgs& args);
+
+    // Full crawl and search, optionally behind the persisted result cache
+    CachedSearch searchCorpus(const std::string& keyword);
+    CachedSearch searchCorpusCached(const std::string& keyword, const std::string& cache_path);
+
+    // Batch mode: evaluate every query against a single crawl, one JSON line per query
+    void runBatchQueries(const std::vector<std::string>& queries, std::ostream& out);
 };
 
 } // namespace wyaFile
@@ -5,6 +5,8 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <functional>
+#include <cstdint>
 
 namespace wyaFile {
 
@@ -14,6 +16,23 @@ using FileContents = std::map<std::string, std::string>;
 // Directory scan result: directory -> file contents
 using DirectoryResult = std::pair<std::string, FileContents>;
 
+// File visitor: called with (filepath, content); return false to stop the traversal
+using FileVisitor = std::function<bool(const std::string&, const std::string&)>;
+
+// Path visitor: called with each candidate filepath; return false to stop the traversal
+using PathVisitor = std::function<bool(const std::string&)>;
+
+// Identity of a file's current contents, as reported by stat()
+struct FileIdentity {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    int64_t mtime_sec = 0;
+    int64_t mtime_nsec = 0;
+    int64_t ctime_sec = 0;  // catches rewrites with a restored mtime, and chmod
+    int64_t ctime_nsec = 0;
+    uint64_t size = 0;
+};
+
 // Search results: list of matching file paths
 using SearchResults = std::vector<std::string>;
 
@@ -0,0 +1,108 @@
+// Local headers
+#include "ContentClassifier.h"
+
+// Standard library headers
+#include <cstring>
+
+namespace wyaFile {
+
+namespace {
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+// True if every byte in the word is printable 7-bit ASCII (0x20..0x7f).
+// Checks eight bytes at once: flags any byte below 0x20 or with its high bit set.
+inline bool isPlainAsciiWord(uint64_t word) {
+    uint64_t below_space = (word - kOnes * 0x20) & ~word & kHighBits;
+    return ((word & kHighBits) | below_space) == 0;
+}
+
+// Control bytes that regularly appear in text files
+inline bool isTextControl(unsigned char byte) {
+    return byte == '\t' || byte == '\n' || byte == '\r' || byte == '\f' || byte == '\v' || byte == 0x1b;
+}
+
+} // namespace
+
+int ContentClassifier::utf8SequenceLength(const unsigned char* data, size_t i, size_t size) {
+    unsigned char lead = data[i];
+    int length;
+    unsigned char min_next = 0x80;
+    unsigned char max_next = 0xbf;
+
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        if (lead == 0xe0) min_next = 0xa0; // overlong
+        if (lead == 0xed) max_next = 0x9f; // surrogates
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        if (lead == 0xf0) min_next = 0x90; // overlong
+        if (lead == 0xf4) max_next = 0x8f; // above U+10FFFF
+    } else {
+        return 0;
+    }
+
+    for (int k = 1; k < length; ++k) {
+        if (i + k >= size) {
+            return -1;
+        }
+        unsigned char next = data[i + k];
+        unsigned char low = (k == 1) ? min_next : 0x80;
+        unsigned char high = (k == 1) ? max_next : 0xbf;
+        if (next < low || next > high) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+ContentKind ContentClassifier::classify(const char* data, size_t size, bool truncated) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t suspicious = 0;
+    size_t i = 0;
+
+    while (i < size) {
+        // Fast path: skip whole words of printable ASCII
+        if (i + sizeof(uint64_t) <= size) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            if (isPlainAsciiWord(word)) {
+                i += sizeof(word);
+                continue;
+            }
+        }
+
+        unsigned char byte = bytes[i];
+        if (byte == 0) {
+            // NUL bytes essentially never occur in text
+            return ContentKind::Binary;
+        }
+
+        if (byte < 0x20) {
+            if (!isTextControl(byte)) {
+                suspicious++;
+            }
+            i++;
+        } else if (byte < 0x80) {
+            i++;
+        } else {
+            int length = utf8SequenceLength(bytes, i, size);
+            if (length > 0) {
+                i += length;
+            } else if (length < 0 && truncated) {
+                break;
+            } else {
+                suspicious++;
+                i++;
+            }
+        }
+    }
+
+    // Tolerate the odd stray byte (e.g. Latin-1 text), but not a prefix full of them
+    return suspicious * 10 > size ? ContentKind::Binary : ContentKind::Text;
+}
+
+} // namespace wyaFile
@@ -0,0 +1,29 @@
+#ifndef WYAFILE_CONTENTCLASSIFIER_H
+#define WYAFILE_CONTENTCLASSIFIER_H
+
+#include "../common/Types.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace wyaFile {
+
+enum class ContentKind { Text, Binary };
+
+// Decides whether a file holds text by sniffing only its first few KB
+class ContentClassifier {
+public:
+    // Number of leading bytes inspected per file
+    static constexpr size_t kSniffBytes = 4096;
+
+    // Classifies a file prefix. `truncated` is true when more bytes follow, so a
+    // multi-byte UTF-8 sequence cut off at the end is not counted against the file.
+    static ContentKind classify(const char* data, size_t size, bool truncated);
+
+    // Length of the valid UTF-8 sequence starting at data[i], 0 if it is invalid,
+    // or -1 if it is cut off by the end of the buffer
+    static int utf8SequenceLength(const unsigned char* data, size_t i, size_t size);
+};
+
+} // namespace wyaFile
+
+#endif // WYAFILE_CONTENTCLASSIFIER_H
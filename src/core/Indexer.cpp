@@ -1,5 +1,6 @@
 // Local headers
 #include "Indexer.h"
+#include "ContentClassifier.h"
 
 // Standard library headers
 #include <fstream>
@@ -9,6 +10,9 @@
 #include <cctype>
 #include <filesystem>
 
+// POSIX headers
+#include <sys/stat.h>
+
 namespace wyaFile {
 
 Indexer::Indexer() {
@@ -41,14 +45,27 @@ std::string Indexer::readFileContent(const std::string& filepath) const {
         return "";
     }
     
-    std::ifstream file(filepath);
+    std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         return "";
     }
-    
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+
+    // Sniff the first few KB and stop reading early if it is binary
+    std::string content(ContentClassifier::kSniffBytes, '\0');
+    file.read(&content[0], static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<size_t>(file.gcount()));
+    bool truncated = !file.eof();
+
+    if (ContentClassifier::classify(content.data(), content.size(), truncated) == ContentKind::Binary) {
+        return "";
+    }
+
+    if (truncated) {
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        content += buffer.str();
+    }
+    return content;
 }
 
 // Helper function to convert text into a list of lowercase alphanumeric "words".
@@ -76,13 +93,15 @@ std::vector<std::string> Indexer::tokenize(const std::string& text) const {
 
 bool Indexer::isSupportedFile(const std::string& filepath) const {
     // Find the last dot in the filename
-    size_t last_dot = filepath.find_last_of('.');
-    if (last_dot == std::string::npos) {
-        return false; // No extension found
+    std::string filename = filepath.substr(filepath.find_last_of("/\\") + 1);
+    size_t last_dot = filename.find_last_of('.');
+    if (last_dot == std::string::npos || last_dot == 0) {
+        // Extensionless files (Makefile, LICENSE, .bashrc) are candidates; content sniffing decides
+        return true;
     }
     
     // Extract the extension (including the dot)
-    std::string extension = filepath.substr(last_dot);
+    std::string extension = filename.substr(last_dot);
     
     // Check if the extension is in our supported list
     return std::find(supported_extensions.begin(), supported_extensions.end(), extension) != supported_extensions.end();
@@ -119,12 +138,11 @@ bool Indexer::shouldSkipFile(const std::string& filepath) const {
     return false;
 }
 
-std::map<std::string, std::string> Indexer::scanDirectoryRecursive(const std::string& directory_path, int current_depth, int max_depth) const {
-    std::map<std::string, std::string> file_contents;
-    
+bool Indexer::walkDirectoryRecursive(const std::string& directory_path, int current_depth, int max_depth,
+                                     const PathVisitor& on_file, const std::atomic<bool>* stop_requested) const {
     // Stop if we've reached max depth
     if (current_depth >= max_depth) {
-        return file_contents;
+        return true;
     }
     
     try {
@@ -132,22 +150,26 @@ std::map<std::string, std::string> Indexer::scanDirectoryRecursive(const std::st
         
         // Check if the directory exists
         if (!std::filesystem::exists(dir_path) || !std::filesystem::is_directory(dir_path)) {
-            return file_contents;
+            return true;
         }
         
         // Iterate through all files and directories
         for (const auto& entry : std::filesystem::directory_iterator(dir_path)) {
+            // Cooperative cancellation: another thread may already have what it needs
+            if (stop_requested && stop_requested->load(std::memory_order_relaxed)) {
+                return false;
+            }
+
             if (entry.is_regular_file()) {
                 std::string filepath = entry.path().string();
                 
-                // Skip files that are too large or not supported
-                if (shouldSkipFile(filepath) || !isSupportedFile(filepath)) {
+                // Skip files that are not supported
+                if (!isSupportedFile(filepath)) {
                     continue;
                 }
                 
-                std::string content = readFileContent(filepath);
-                if (!content.empty()) {
-                    file_contents[filepath] = content;
+                if (!on_file(filepath)) {
+                    return false;
                 }
             }
             else if (entry.is_directory()) {
@@ -159,8 +181,9 @@ std::map<std::string, std::string> Indexer::scanDirectoryRecursive(const std::st
                 }
                 
                 std::string dirpath = entry.path().string();
-                std::map<std::string, std::string> dir_contents = scanDirectoryRecursive(dirpath, current_depth + 1, max_depth);
-                file_contents.insert(dir_contents.begin(), dir_contents.end());
+                if (!walkDirectoryRecursive(dirpath, current_depth + 1, max_depth, on_file, stop_requested)) {
+                    return false;
+                }
             }
         }
         
@@ -170,12 +193,80 @@ std::map<std::string, std::string> Indexer::scanDirectoryRecursive(const std::st
         std::cerr << "Error scanning directory " << directory_path << ": " << e.what() << std::endl;
     }
     
-    return file_contents;
+    return true;
 }
 
 std::map<std::string, std::string> Indexer::scanDirectory(const std::string& directory_path) const {
-    // Use recursive scanning with guardrails (max depth of 3)
-    return scanDirectoryRecursive(directory_path, 0, 5);
+    std::map<std::string, std::string> file_contents;
+    visitDirectory(directory_path, [&file_contents](const std::string& filepath, const std::string& content) {
+        file_contents[filepath] = content;
+        return true;
+    });
+    return file_contents;
+}
+
+bool Indexer::visitDirectory(const std::string& directory_path, const FileVisitor& visitor,
+                             const std::atomic<bool>* stop_requested) const {
+    // Use recursive scanning with guardrails (max depth of 5)
+    return walkDirectoryRecursive(directory_path, 0, 5, [this, &visitor](const std::string& filepath) {
+        // Skip files that are too large
+        if (shouldSkipFile(filepath)) {
+            return true;
+        }
+
+        std::string content = readFileContent(filepath);
+        return content.empty() || visitor(filepath, content);
+    }, stop_requested);
+}
+
+uint64_t Indexer::fingerprintDirectory(const std::string& directory_path) const {
+    // Order-independent sum of per-file hashes, so iteration order does not matter
+    uint64_t fingerprint = hashBytes(directory_path, 0);
+    walkDirectoryRecursive(directory_path, 0, 5, [&fingerprint](const std::string& filepath) {
+        FileIdentity identity;
+        if (!identifyFile(filepath, identity)) {
+            return true;
+        }
+
+        uint64_t file_hash = hashBytes(filepath, 0);
+        file_hash = hashBytes(std::string(reinterpret_cast<const char*>(&identity), sizeof(identity)), file_hash);
+        fingerprint += file_hash * 0x9e3779b97f4a7c15ULL + 1;
+        return true;
+    }, nullptr);
+    return fingerprint;
+}
+
+bool Indexer::identifyFile(const std::string& filepath, FileIdentity& identity) {
+    struct stat info;
+    if (::stat(filepath.c_str(), &info) != 0) {
+        return false;
+    }
+
+    identity.device = static_cast<uint64_t>(info.st_dev);
+    identity.inode = static_cast<uint64_t>(info.st_ino);
+    identity.size = static_cast<uint64_t>(info.st_size);
+#ifdef __APPLE__
+    identity.mtime_sec = static_cast<int64_t>(info.st_mtimespec.tv_sec);
+    identity.mtime_nsec = static_cast<int64_t>(info.st_mtimespec.tv_nsec);
+    identity.ctime_sec = static_cast<int64_t>(info.st_ctimespec.tv_sec);
+    identity.ctime_nsec = static_cast<int64_t>(info.st_ctimespec.tv_nsec);
+#else
+    identity.mtime_sec = static_cast<int64_t>(info.st_mtim.tv_sec);
+    identity.mtime_nsec = static_cast<int64_t>(info.st_mtim.tv_nsec);
+    identity.ctime_sec = static_cast<int64_t>(info.st_ctim.tv_sec);
+    identity.ctime_nsec = static_cast<int64_t>(info.st_ctim.tv_nsec);
+#endif
+    return true;
+}
+
+uint64_t Indexer::hashBytes(const std::string& bytes, uint64_t seed) {
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL ^ seed;
+    for (char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
 }
 
 } // namespace wyaFile
\ No newline at end of file
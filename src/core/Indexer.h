@@ -2,6 +2,8 @@
 #define NEXUSSCAN_INDEXER_H
 
 #include "../common/Types.h"
+#include <atomic>
+#include <cstdint>
 
 namespace wyaFile {
 
@@ -10,21 +12,39 @@ private:
     FileExtensions supported_extensions;
     SkipDirectories skip_directories;
     
-    // Recursive scanning with guardrails
-    FileContents scanDirectoryRecursive(const std::string& directory_path, int current_depth, int max_depth) const;
+    // Recursive walk over candidate files with guardrails; returns false once the walk was stopped
+    bool walkDirectoryRecursive(const std::string& directory_path, int current_depth, int max_depth,
+                                const PathVisitor& on_file, const std::atomic<bool>* stop_requested) const;
     bool shouldSkipDirectory(const std::string& dirname) const;
     bool shouldSkipFile(const std::string& filepath) const;
 
 public:
     Indexer();
 
+    // Returns the file's content, or "" if it is unreadable or sniffed as binary
     std::string readFileContent(const std::string& filepath) const;
     std::vector<std::string> tokenize(const std::string& text) const;
     
     // New method to scan directory and read all .txt files
     FileContents scanDirectory(const std::string& directory_path) const;
+
+    // Streams each readable file to the visitor as soon as it is read. Stops early when
+    // the visitor returns false or stop_requested is set; returns false if stopped early.
+    bool visitDirectory(const std::string& directory_path, const FileVisitor& visitor,
+                        const std::atomic<bool>* stop_requested = nullptr) const;
+
+    // Hash of every candidate file's path, inode, size, mtime and ctime under directory_path.
+    // Only stats files, so it is far cheaper than a scan; changes whenever the scan would.
+    uint64_t fingerprintDirectory(const std::string& directory_path) const;
+
+    // 64-bit FNV-1a hash of bytes, chained through seed
+    static uint64_t hashBytes(const std::string& bytes, uint64_t seed);
+
+    // Reads the identity of filepath; returns false if it cannot be stat'ed
+    static bool identifyFile(const std::string& filepath, FileIdentity& identity);
     
-    // Helper method to check if a file has .txt extension
+    // Whether a file is a search candidate: a known text extension or no extension at all.
+    // Candidates are still content-sniffed on read, so binaries are never returned.
     bool isSupportedFile(const std::string& filepath) const;
     bool fileExists(const std::string& filepath) const;
 };
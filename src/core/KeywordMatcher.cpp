@@ -0,0 +1,125 @@
+// Local headers
+#include "KeywordMatcher.h"
+
+// Standard library headers
+#include <algorithm>
+#include <queue>
+#include <cctype>
+
+namespace wyaFile {
+
+KeywordMatcher::KeywordMatcher(const std::vector<std::string>& keywords)
+    : keyword_count(keywords.size()) {
+    root_next.fill(-1);
+    nodes.emplace_back();
+
+    // Insert each keyword into the trie
+    for (size_t id = 0; id < keywords.size(); ++id) {
+        const std::string& keyword = keywords[id];
+        if (keyword.empty()) {
+            continue;
+        }
+
+        int32_t current = 0;
+        for (char c : keyword) {
+            unsigned char byte = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+            int32_t next = (current == 0) ? root_next[byte] : child(current, byte);
+            if (next == -1) {
+                next = static_cast<int32_t>(nodes.size());
+                nodes.emplace_back();
+                if (current == 0) {
+                    root_next[byte] = next;
+                } else {
+                    auto& children = nodes[current].children;
+                    auto pos = std::lower_bound(children.begin(), children.end(), std::make_pair(byte, int32_t(0)));
+                    children.insert(pos, std::make_pair(byte, next));
+                }
+            }
+            current = next;
+        }
+        nodes[current].keyword_ids.push_back(id);
+    }
+
+    build();
+}
+
+int32_t KeywordMatcher::child(int32_t node, unsigned char byte) const {
+    const auto& children = nodes[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(byte, int32_t(0)));
+    return (it != children.end() && it->first == byte) ? it->second : -1;
+}
+
+int32_t KeywordMatcher::step(int32_t node, unsigned char byte) const {
+    // Follow failure links until some suffix can be extended by byte
+    while (node != 0) {
+        int32_t next = child(node, byte);
+        if (next != -1) {
+            return next;
+        }
+        node = nodes[node].fail;
+    }
+    return root_next[byte];
+}
+
+void KeywordMatcher::build() {
+    // Breadth-first pass computing failure and output links
+    std::queue<int32_t> pending;
+
+    for (int byte = 0; byte < 256; ++byte) {
+        int32_t first = root_next[byte];
+        if (first == -1) {
+            root_next[byte] = 0;
+        } else {
+            nodes[first].fail = 0;
+            pending.push(first);
+        }
+    }
+
+    while (!pending.empty()) {
+        int32_t current = pending.front();
+        pending.pop();
+
+        int32_t fail = nodes[current].fail;
+        nodes[current].output_link = nodes[fail].keyword_ids.empty() ? nodes[fail].output_link : fail;
+
+        for (const auto& [byte, next] : nodes[current].children) {
+            nodes[next].fail = step(fail, byte);
+            pending.push(next);
+        }
+    }
+}
+
+std::vector<size_t> KeywordMatcher::findMatches(const std::string& text, Scratch& scratch) const {
+    std::vector<size_t> matches;
+    if (keyword_count == 0) {
+        return matches;
+    }
+
+    // A fresh stamp marks this text; stamps are only cleared when the counter wraps
+    if (scratch.reported.size() != nodes.size() || ++scratch.stamp == 0) {
+        scratch.reported.assign(nodes.size(), 0);
+        scratch.stamp = 1;
+    }
+
+    int32_t current = 0;
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+        current = step(current, byte);
+
+        // Nodes whose output chain has already been reported for this text are skipped
+        int32_t output = nodes[current].keyword_ids.empty() ? nodes[current].output_link : current;
+        while (output > 0 && scratch.reported[output] != scratch.stamp) {
+            scratch.reported[output] = scratch.stamp;
+            matches.insert(matches.end(), nodes[output].keyword_ids.begin(), nodes[output].keyword_ids.end());
+            output = nodes[output].output_link;
+        }
+
+        if (matches.size() == keyword_count) {
+            break;
+        }
+    }
+
+    return matches;
+}
+
+} // namespace wyaFile
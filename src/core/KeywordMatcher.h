@@ -0,0 +1,50 @@
+#ifndef WYAFILE_KEYWORDMATCHER_H
+#define WYAFILE_KEYWORDMATCHER_H
+
+#include "../common/Types.h"
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace wyaFile {
+
+// Case-insensitive multi-keyword matcher (Aho-Corasick automaton).
+// Finds every keyword occurring in a text with a single pass over it.
+class KeywordMatcher {
+private:
+    struct Node {
+        std::vector<std::pair<unsigned char, int32_t> > children; // sorted by byte
+        int32_t fail = 0;
+        int32_t output_link = -1;       // nearest suffix node that ends a keyword
+        std::vector<size_t> keyword_ids; // keywords ending exactly at this node
+    };
+
+    // The root keeps a dense table since nearly every byte starts there; other nodes are sparse
+    std::array<int32_t, 256> root_next;
+    std::vector<Node> nodes;
+    size_t keyword_count = 0;
+
+    int32_t child(int32_t node, unsigned char byte) const;
+    int32_t step(int32_t node, unsigned char byte) const;
+    void build();
+
+public:
+    // Per-thread working memory reused across texts, so a search costs O(text + matches)
+    // rather than O(automaton size). Not shareable between concurrent searches.
+    struct Scratch {
+        std::vector<uint32_t> reported; // stamp of the text a node was last reported in
+        uint32_t stamp = 0;
+    };
+
+    // Keywords are matched case-insensitively; empty keywords never match
+    explicit KeywordMatcher(const std::vector<std::string>& keywords);
+
+    // Returns the ids (indices into the constructor's list) of keywords found in text
+    std::vector<size_t> findMatches(const std::string& text, Scratch& scratch) const;
+
+    size_t size() const { return keyword_count; }
+};
+
+} // namespace wyaFile
+
+#endif // WYAFILE_KEYWORDMATCHER_H
@@ -0,0 +1,268 @@
+// Local headers
+#include "ResultCache.h"
+
+// Standard library headers
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+// POSIX headers
+#include <unistd.h>
+
+namespace wyaFile {
+
+namespace {
+
+const char kCacheMagic[] = "WYARC1";
+
+// Length-prefixed binary encoding for the on-disk tier
+void writeNumber(std::ostream& out, uint64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeString(std::ostream& out, const std::string& value) {
+    writeNumber(out, value.size());
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+void writeStrings(std::ostream& out, const std::vector<std::string>& values) {
+    writeNumber(out, values.size());
+    for (const auto& value : values) {
+        writeString(out, value);
+    }
+}
+
+bool readNumber(std::istream& in, uint64_t& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return static_cast<bool>(in);
+}
+
+bool readString(std::istream& in, std::string& value) {
+    uint64_t size;
+    // Guard against corrupt lengths before allocating
+    if (!readNumber(in, size) || size > (1u << 20)) {
+        return false;
+    }
+    value.resize(size);
+    in.read(&value[0], static_cast<std::streamsize>(size));
+    return static_cast<bool>(in);
+}
+
+bool readStrings(std::istream& in, std::vector<std::string>& values) {
+    uint64_t count;
+    if (!readNumber(in, count) || count > (1u << 20)) {
+        return false;
+    }
+    values.resize(count);
+    for (auto& value : values) {
+        if (!readString(in, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ResultCache::ResultCache(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {}
+
+std::string ResultCache::makeKey(const std::string& query, const std::vector<std::string>& roots) {
+    std::string key;
+    size_t start = query.find_first_not_of(" \t\r\n");
+    if (start != std::string::npos) {
+        size_t end = query.find_last_not_of(" \t\r\n");
+        key = query.substr(start, end - start + 1);
+    }
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+    std::vector<std::string> sorted_roots(roots);
+    std::sort(sorted_roots.begin(), sorted_roots.end());
+    sorted_roots.erase(std::unique(sorted_roots.begin(), sorted_roots.end()), sorted_roots.end());
+
+    // NUL cannot appear in a query or path, so it is a safe separator
+    for (const auto& root : sorted_roots) {
+        key += '\0';
+        key += root;
+    }
+    return key;
+}
+
+uint64_t ResultCache::observeCorpus(uint64_t fingerprint) {
+    if (!corpus_observed) {
+        corpus_observed = true;
+        corpus_fingerprint = fingerprint;
+    } else if (fingerprint != corpus_fingerprint) {
+        corpus_fingerprint = fingerprint;
+        corpus_generation++;
+        modified = true;
+        evictStale();
+    }
+    return corpus_generation;
+}
+
+void ResultCache::evictStale() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->generation != corpus_generation) {
+            index.erase(it->key);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ResultCache::get(const std::string& key, CachedSearch& search) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
+    }
+
+    // Never serve results computed against an older corpus
+    if (it->second->generation != corpus_generation) {
+        entries.erase(it->second);
+        index.erase(it);
+        return false;
+    }
+
+    // Record the recency bump so it is persisted; eviction order must follow use, not insertion
+    if (it->second != entries.begin()) {
+        entries.splice(entries.begin(), entries, it->second);
+        modified = true;
+    }
+    search = it->second->search;
+    return true;
+}
+
+void ResultCache::put(const std::string& key, const CachedSearch& search) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    entries.push_front(Entry{key, corpus_generation, search});
+    modified = true;
+    index[key] = entries.begin();
+
+    // Evict least recently used entries
+    while (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+bool ResultCache::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(kCacheMagic)] = {};
+    file.read(magic, sizeof(kCacheMagic) - 1);
+    if (!file || std::string(magic) != kCacheMagic) {
+        return false;
+    }
+
+    uint64_t fingerprint, generation, count;
+    if (!readNumber(file, fingerprint) || !readNumber(file, generation) || !readNumber(file, count)) {
+        return false;
+    }
+
+    std::list<Entry> loaded;
+    for (uint64_t i = 0; i < count; ++i) {
+        Entry entry;
+        if (!readString(file, entry.key) || !readNumber(file, entry.generation) ||
+            !readStrings(file, entry.search.scanned_directories) ||
+            !readStrings(file, entry.search.matching_files)) {
+            return false;
+        }
+        loaded.push_back(std::move(entry));
+    }
+
+    // Adopt the persisted generation, then re-observe the fingerprint seen in this
+    // process (if any) so a change since the file was written still advances it
+    bool observed = corpus_observed;
+    uint64_t current_fingerprint = corpus_fingerprint;
+
+    entries.swap(loaded);
+    index.clear();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        index[it->key] = it;
+    }
+    corpus_fingerprint = fingerprint;
+    corpus_generation = generation;
+    corpus_observed = true;
+    modified = false;
+
+    if (observed) {
+        observeCorpus(current_fingerprint);
+    }
+    evictStale();
+
+    while (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+    return true;
+}
+
+bool ResultCache::save(const std::string& path) const {
+    try {
+        std::filesystem::path target(path);
+        if (target.has_parent_path()) {
+            std::filesystem::create_directories(target.parent_path());
+        }
+
+        // Write to a uniquely named temporary file and rename, so readers never see a
+        // partial cache and concurrent writers never interleave within one file
+        std::string temp_path = path + ".XXXXXX";
+        int fd = ::mkstemp(&temp_path[0]);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+
+        bool written = false;
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (file.is_open()) {
+                file.write(kCacheMagic, sizeof(kCacheMagic) - 1);
+                writeNumber(file, corpus_fingerprint);
+                writeNumber(file, corpus_generation);
+                writeNumber(file, entries.size());
+                for (const auto& entry : entries) {
+                    writeString(file, entry.key);
+                    writeNumber(file, entry.generation);
+                    writeStrings(file, entry.search.scanned_directories);
+                    writeStrings(file, entry.search.matching_files);
+                }
+                written = static_cast<bool>(file);
+            }
+        }
+
+        if (!written) {
+            std::filesystem::remove(temp_path);
+            return false;
+        }
+        std::filesystem::rename(temp_path, path);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::string ResultCache::defaultPath() {
+    const char* xdg_cache = std::getenv("XDG_CACHE_HOME");
+    if (xdg_cache && *xdg_cache) {
+        return std::string(xdg_cache) + "/wya/results.cache";
+    }
+    const char* home_env = std::getenv("HOME");
+    if (home_env) {
+        return std::string(home_env) + "/.cache/wya/results.cache";
+    }
+    return "";
+}
+
+} // namespace wyaFile
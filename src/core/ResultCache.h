@@ -0,0 +1,67 @@
+#ifndef WYAFILE_RESULTCACHE_H
+#define WYAFILE_RESULTCACHE_H
+
+#include "../common/Types.h"
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace wyaFile {
+
+// Cached outcome of one keyword search
+struct CachedSearch {
+    std::vector<std::string> scanned_directories; // roots that held any files
+    SearchResults matching_files;
+};
+
+// LRU cache of keyword search results, keyed by normalized query and root set.
+// Every entry is tagged with the corpus generation it was computed in; the generation
+// advances whenever the corpus fingerprint changes, and older entries are never served.
+class ResultCache {
+private:
+    struct Entry {
+        std::string key;
+        uint64_t generation;
+        CachedSearch search;
+    };
+
+    size_t capacity;
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+    uint64_t corpus_fingerprint = 0;
+    uint64_t corpus_generation = 0;
+    bool corpus_observed = false;
+    bool modified = false; // entries, their order or the generation changed since load()
+
+    void evictStale();
+
+public:
+    explicit ResultCache(size_t capacity = 128);
+
+    // Cache key: lowercased, trimmed query plus the sorted set of roots
+    static std::string makeKey(const std::string& query, const std::vector<std::string>& roots);
+
+    // Records the current corpus fingerprint and returns the corpus generation,
+    // advancing it (and dropping every cached entry) if the fingerprint changed
+    uint64_t observeCorpus(uint64_t fingerprint);
+    uint64_t generation() const { return corpus_generation; }
+
+    // True if the persisted tier is out of date, including LRU order bumped by get()
+    bool isModified() const { return modified; }
+
+    // Returns true and fills `search` only for entries of the current generation
+    bool get(const std::string& key, CachedSearch& search);
+    void put(const std::string& key, const CachedSearch& search);
+
+    // Optional persisted tier. A missing or malformed file loads as an empty cache.
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Default on-disk location: $XDG_CACHE_HOME/wya or ~/.cache/wya
+    static std::string defaultPath();
+};
+
+} // namespace wyaFile
+
+#endif // WYAFILE_RESULTCACHE_H
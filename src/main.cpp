@@ -19,4 +19,7 @@ int main(int argc, char* argv[]) {
 
     // Parse and execute the command
     std::string result = commandParser.parseCommand(command);
+    if (!result.empty()) {
+        std::cout << result << std::endl;
+    }
 }
\ No newline at end of file